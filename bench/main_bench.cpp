@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "event_journal.hpp"
+#include "order_book.hpp"
+#include "order_gateway.hpp"
+
+using bench_clock = std::chrono::steady_clock;
+
+// Gateway throughput as the number of producer threads grows. Every producer
+// submits its share of a fixed request count and drains its own acks.
+void bench_gateway_scaling(int total_requests) {
+    std::cout << "Gateway producer scaling (" << total_requests << " requests)\n"
+              << "producers  Mreq/s\n";
+
+    for (int producers : {1, 2, 4, 8, 16}) {
+        OrderBook book;
+        OrderGateway gateway(book, producers);
+        gateway.start();
+
+        int per_producer = total_requests / producers;
+        auto start = bench_clock::now();
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                OrderAck ack;
+                int submitted = 0;
+                int acked = 0;
+                while (acked < per_producer) {
+                    while (gateway.poll_ack(p, ack)) acked++;
+                    if (submitted < per_producer) {
+                        int id = p * per_producer + submitted + 1;
+                        // Unknown ids keep the book out of the measurement
+                        if (gateway.submit_cancel(p, id)) submitted++;
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        auto elapsed = std::chrono::duration<double>(bench_clock::now() - start).count();
+        gateway.stop();
+
+        std::cout << std::setw(9) << producers << "  " << std::fixed << std::setprecision(2)
+                  << (per_producer * producers) / elapsed / 1e6 << "\n";
+    }
+    std::cout << "\n";
+}
+
+void print_percentiles(const std::string& label, std::vector<int64_t>& samples) {
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<std::size_t>(q * (samples.size() - 1))]; };
+    std::cout << std::left << std::setw(24) << label << std::right
+              << std::setw(8) << at(0.50) << std::setw(8) << at(0.99)
+              << std::setw(8) << at(0.999) << "\n";
+}
+
+// Latency the journal adds to the matching path: a single-threaded log_add()
+// per sample, timed individually. The clock-only row is the timing overhead
+// included in every other row.
+void bench_journal_append(int samples) {
+    std::string path = "lob_bench_journal.bin";
+    std::remove(path.c_str());
+
+    std::vector<int64_t> clock_only;
+    std::vector<int64_t> log_add;
+    clock_only.reserve(samples);
+    log_add.reserve(samples);
+
+    EventJournal journal;
+    if (!journal.open(path)) {
+        std::cerr << "Failed to open " << path << "\n";
+        return;
+    }
+    Order order(1, 100.0, 10, true, std::chrono::nanoseconds(0));
+    for (int i = 0; i < samples; ++i) {
+        auto t0 = bench_clock::now();
+        auto t1 = bench_clock::now();
+        journal.log_add(order);
+        auto t2 = bench_clock::now();
+        clock_only.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        log_add.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count());
+    }
+    journal.close();
+    std::remove(path.c_str());
+
+    std::cout << "Journal append latency (" << samples << " samples, ns)\n"
+              << std::left << std::setw(24) << "" << std::right
+              << std::setw(8) << "p50" << std::setw(8) << "p99" << std::setw(8) << "p99.9" << "\n";
+    print_percentiles("clock only", clock_only);
+    print_percentiles("log_add", log_add);
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    int total_requests = argc > 1 ? std::stoi(argv[1]) : 1 << 21;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+    bench_gateway_scaling(total_requests);
+    bench_journal_append(1000000);
+    return 0;
+}
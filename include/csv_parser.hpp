@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <map>
+#include <functional>
 #include "order.hpp"
 
 class CSVParser {
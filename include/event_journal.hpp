@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "lock_free_queue.hpp"
+#include "order.hpp"
+#include "order_book.hpp"
+
+enum class JournalEvent : uint8_t { Add = 1, Cancel = 2, Amend = 3, Fill = 4 };
+
+// Fixed-size on-disk record (native byte order)
+struct JournalRecord {
+    uint8_t event = 0;
+    uint8_t is_buy = 0;
+    uint16_t reserved = 0;
+    int32_t order_id = 0;         // Fill: bid order id
+    int32_t quantity = 0;
+    uint32_t checksum = 0;
+    double price = 0.0;
+    int64_t aux = 0;              // Add: timestamp in ns; Fill: ask order id
+    uint64_t sequence = 0;        // Position in the journal, starting at 0
+    uint64_t input_position = 0;  // Caller's tag from set_input_position(); 0 if unset
+};
+static_assert(sizeof(JournalRecord) == 48, "journal record layout changed");
+
+// Append-only write-ahead journal of accepted book events.
+//
+// The matching thread copies each record into a preallocated SPSC ring; a
+// background writer drains it in batches with write() and group-commits with
+// fdatasync() at most `durability_window` after a record is written. Records
+// are checksummed on the writer thread and numbered, and a torn tail left by a
+// crash is dropped on the next open(). The writer is fail-stop: after the first
+// write or sync error it discards everything and never writes again, so the
+// file is always a gap-free prefix of what was logged.
+class EventJournal {
+public:
+    // The default ring (4096 records, 192 KB) stays cache-resident on the
+    // matching core; a larger ring only absorbs longer writer stalls
+    explicit EventJournal(std::chrono::microseconds durability_window = std::chrono::microseconds(1000),
+                          std::size_t buffer_records = 1 << 12);
+    ~EventJournal();
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    // Creates the file or appends to an existing journal, then starts the writer.
+    // The intact records already in the journal are returned in `recovered`.
+    bool open(const std::string& filename, std::vector<JournalRecord>* recovered = nullptr);
+    // Makes everything durable and stops the writer
+    void close();
+
+    // Matching path; single thread only. Logging while the journal is not open
+    // drops the record and sets has_failed().
+    void log_add(const Order& order);
+    void log_cancel(int order_id);
+    void log_amend(int order_id, double new_price, int new_quantity);
+    void log_fill(int bid_id, int ask_id, double price, int quantity);
+    // Tags every following record, e.g. with the 1-based input row being processed
+    void set_input_position(uint64_t position) { input_position_ = position; }
+
+    // Blocks until every record logged so far is durable (or the writer failed)
+    void flush();
+
+    // Statistics
+    uint64_t get_logged_count() const { return logged_; }
+    uint64_t get_durable_count() const { return durable_.load(std::memory_order_acquire); }
+    bool has_failed() const { return failed_.load(std::memory_order_acquire); }
+
+    // Recovery: reads every intact record, stopping at the first torn, corrupt or
+    // out-of-sequence one
+    static bool read_records(const std::string& filename, std::vector<JournalRecord>& records);
+    // Rebuilds a book from records; the book must not have a journal attached
+    static void replay(OrderBook& book, const std::vector<JournalRecord>& records);
+
+private:
+    friend struct EventJournalTestAccess;
+
+    void append(JournalRecord record);
+    void run();
+    bool write_batch(std::size_t count);
+    static uint32_t checksum(const JournalRecord& record);
+
+    std::chrono::microseconds durability_window_;
+    SpscRing<JournalRecord> ring_;
+    std::vector<JournalRecord> batch_;  // Writer thread only
+
+    int fd_ = -1;
+    std::thread writer_;
+    uint64_t logged_ = 0;          // Matching thread only
+    uint64_t next_sequence_ = 0;   // Matching thread only
+    uint64_t input_position_ = 0;  // Matching thread only
+    std::atomic<uint64_t> durable_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<bool> flush_requested_{false};
+    std::atomic<bool> failed_{false};
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary indexed tree over an append-only sequence of slots.
+// Point updates and prefix sums are O(log n); appending a slot is O(log n).
+class FenwickTree {
+public:
+    FenwickTree() = default;
+
+    // Appends a new slot holding `value`
+    void push_back(int64_t value);
+    // Adds `delta` to slot `index` (0-based)
+    void add(std::size_t index, int64_t delta);
+    // Sum of slots [0, count)
+    int64_t prefix_sum(std::size_t count) const;
+    // Current value of slot `index`
+    int64_t value(std::size_t index) const;
+
+    std::size_t size() const { return tree_.size() - 1; }
+    void clear() { tree_.assign(1, 0); }
+
+private:
+    static std::size_t lowbit(std::size_t i) { return i & (~i + 1); }
+
+    std::vector<int64_t> tree_{0};  // 1-based; tree_[0] is unused
+};
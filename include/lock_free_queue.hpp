@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Cache line size used to keep producer and consumer indices apart
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// Bounded lock-free multi-producer / single-consumer queue.
+//
+// Each cell carries a sequence counter (Vyukov-style). Producers claim a slot
+// by CAS on the enqueue position, so the position a push lands on is a unique,
+// gap-free ticket that doubles as a global sequence number. The single consumer
+// pops strictly in that order. close() sets a flag bit in the enqueue position,
+// so no ticket can be issued after it returns.
+template <typename T>
+class MpscQueue {
+public:
+    // Capacity is rounded up to the next power of two
+    explicit MpscQueue(std::size_t capacity)
+        : mask_(round_up_pow2(capacity) - 1)
+        , cells_(new Cell[mask_ + 1]) {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Returns false if the queue is full or closed. On success `ticket` receives
+    // the position the item was enqueued at.
+    bool try_push(const T& item, uint64_t& ticket) {
+        uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (pos & CLOSED_BIT) return false;
+            Cell& cell = cells_[pos & mask_];
+            uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    cell.data = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    ticket = pos;
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only. Returns false if the next item is not yet published.
+    bool try_pop(T& item) {
+        Cell& cell = cells_[dequeue_pos_ & mask_];
+        uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (seq != dequeue_pos_ + 1) return false;
+
+        item = cell.data;
+        cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+    // Stops further pushes and returns the number of tickets ever issued
+    uint64_t close() {
+        return enqueue_pos_.fetch_or(CLOSED_BIT, std::memory_order_acq_rel) & ~CLOSED_BIT;
+    }
+
+    bool is_closed() const {
+        return (enqueue_pos_.load(std::memory_order_acquire) & CLOSED_BIT) != 0;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    // One cell per cache line so producers on neighbouring tickets don't share one
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<uint64_t> sequence;
+        T data;
+    };
+
+    static constexpr uint64_t CLOSED_BIT = uint64_t(1) << 63;
+
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> enqueue_pos_{0};
+    alignas(CACHE_LINE_SIZE) uint64_t dequeue_pos_ = 0;
+};
+
+// Bounded lock-free single-producer / single-consumer ring buffer.
+template <typename T>
+class SpscRing {
+public:
+    // Capacity is rounded up to the next power of two
+    explicit SpscRing(std::size_t capacity)
+        : mask_(round_up_pow2(capacity) - 1)
+        , slots_(new T[mask_ + 1]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    bool try_push(const T& item) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ > mask_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ > mask_) return false;
+        }
+        slots_[head & mask_] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) return false;
+        }
+        item = slots_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const std::size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    // Producer side
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0};
+    uint64_t cached_tail_ = 0;
+    // Consumer side
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_{0};
+    uint64_t cached_head_ = 0;
+};
@@ -4,8 +4,12 @@
 #include <vector>
 #include <chrono>
 #include <string>
+#include <unordered_map>
+#include "fenwick_tree.hpp"
 #include "order.hpp"
 
+class EventJournal;
+
 class OrderBook {
 public:
     OrderBook();
@@ -13,7 +17,10 @@ public:
 
     // Core functionality
     bool add_order(const Order& order);
+    // Cancel and amend find the order in O(log n); erasing it from the level
+    // vector still shifts the orders behind it (O(level size))
     bool cancel_order(int order_id);
+    bool amend_order(int order_id, double new_price, int new_quantity);
     void match_orders();
 
     // Getters
@@ -23,10 +30,18 @@ public:
     int get_ask_volume() const;
     double get_spread() const;
 
+    // Queue queries for resting orders, O(log n) in the level size.
+    // Both return -1 if the order is not resting in the book.
+    int queue_position(int order_id) const;  // Orders ahead at the same price (0 = front)
+    int volume_ahead(int order_id) const;    // Quantity ahead at the same price
+
     // Statistics
     double get_average_execution_latency() const;
     std::string get_book_state() const;
 
+    // Journal every accepted add, cancel, amend and fill (nullptr to detach)
+    void set_journal(EventJournal* journal) { journal_ = journal; }
+
     // Export functionality
     void export_to_csv(const std::string& filename) const;
 
@@ -35,12 +50,42 @@ private:
     std::map<double, std::vector<Order>, std::greater<double>> bids_;  // Descending order for bids
     std::map<double, std::vector<Order>> asks_;  // Ascending order for asks
 
+    // Per-level FIFO index: one slot per order in arrival order, zeroed on removal
+    struct LevelQueue {
+        FenwickTree volume;    // Remaining quantity per slot
+        FenwickTree count;     // 1 per live order
+        std::size_t live = 0;
+    };
+
+    struct OrderSlot {
+        bool is_buy;
+        double price;
+        LevelQueue* queue;
+        std::size_t slot;
+    };
+
+    std::map<double, LevelQueue, std::greater<double>> bid_queues_;
+    std::map<double, LevelQueue> ask_queues_;
+    std::unordered_map<int, OrderSlot> order_index_;
+
+    EventJournal* journal_;
+
     // Statistics
     std::vector<std::chrono::nanoseconds> execution_latencies_;
     int total_matches_;
 
     // Helper methods
+    void insert_order(const Order& order);
     void match_orders_at_price(double price);
     void remove_empty_price_levels();
     bool try_match_orders(Order& bid, Order& ask);
+
+    // Queue index maintenance
+    std::vector<Order>& level_orders(bool is_buy, double price);
+    std::size_t level_index(const OrderSlot& slot) const;
+    void erase_level_if_empty(bool is_buy, double price);
+    void track_order(const Order& order);
+    void update_tracked_quantity(int order_id, int delta);
+    void untrack_order(int order_id);
+    void compact_queue(bool is_buy, double price, LevelQueue& queue);
 }; 
\ No newline at end of file
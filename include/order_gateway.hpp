@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "lock_free_queue.hpp"
+#include "order.hpp"
+#include "order_book.hpp"
+
+enum class RequestType { Add, Cancel, Amend };
+
+struct OrderRequest {
+    RequestType type = RequestType::Add;
+    int producer_id = 0;
+    int order_id = 0;
+    double price = 0.0;
+    int quantity = 0;
+    bool is_buy = false;
+    std::chrono::nanoseconds timestamp{0};
+};
+
+struct OrderAck {
+    uint64_t sequence = 0;
+    OrderRequest request;
+    bool accepted = false;
+};
+
+// Multi-producer submission front-end for a single OrderBook.
+//
+// Producer threads submit add/cancel/amend requests through a lock-free MPSC
+// queue; the enqueue position is the request's global sequence number. A single
+// matching thread applies requests in sequence order and returns an OrderAck
+// on the submitting producer's own SPSC response ring.
+//
+// Producers must keep draining their acks with poll_ack(). A submit_* call
+// returns false before start(), after stop(), or when the request queue is
+// full; in the last case poll acks and retry. Every accepted request is
+// applied. Its ack is delivered too, unless the producer's ack ring is still
+// full while the gateway is stopping; such acks are dropped and counted in
+// get_dropped_ack_count().
+class OrderGateway {
+public:
+    OrderGateway(OrderBook& book, int num_producers,
+                 std::size_t queue_capacity = 1 << 16,
+                 std::size_t ack_capacity = 1 << 16);
+    ~OrderGateway();
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    // Matching thread control. stop() rejects further submissions, applies every
+    // request already accepted and joins the matching thread. A stopped gateway
+    // cannot be restarted. Call start()/stop() from one controlling thread.
+    void start();
+    void stop();
+
+    // Producer side (producer_id in [0, num_producers))
+    bool submit_add(int producer_id, const Order& order, uint64_t* sequence = nullptr);
+    bool submit_cancel(int producer_id, int order_id, uint64_t* sequence = nullptr);
+    bool submit_amend(int producer_id, int order_id, double new_price, int new_quantity,
+                      uint64_t* sequence = nullptr);
+    bool poll_ack(int producer_id, OrderAck& ack);
+
+    // Statistics
+    uint64_t get_processed_count() const { return processed_.load(std::memory_order_acquire); }
+    uint64_t get_dropped_ack_count() const { return dropped_acks_.load(std::memory_order_acquire); }
+
+    // Applies a single request to a book; shared by the matching thread and replay
+    static bool apply(OrderBook& book, const OrderRequest& request);
+
+private:
+    bool submit(OrderRequest request, uint64_t* sequence);
+    void run();
+    void process(const OrderRequest& request, uint64_t sequence);
+
+    OrderBook& book_;
+    MpscQueue<OrderRequest> requests_;
+    std::vector<std::unique_ptr<SpscRing<OrderAck>>> acks_;
+
+    std::thread matcher_;
+    uint64_t next_sequence_ = 0;  // Matching thread only; mirrors the queue's dequeue position
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};  // Set once by the first stop()
+    std::atomic<uint64_t> issued_{0};  // Tickets issued before close(); set by stop()
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> dropped_acks_{0};
+};
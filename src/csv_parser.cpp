@@ -2,6 +2,7 @@
 #include <sstream>
 #include <fstream>
 #include <stdexcept>
+#include <iomanip>
 
 bool CSVParser::read_orders(const std::string& filename, std::vector<Order>& orders) {
     std::ifstream file(filename);
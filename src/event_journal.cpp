@@ -0,0 +1,268 @@
+#include "event_journal.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char JOURNAL_MAGIC[8] = {'L', 'O', 'B', 'J', 'R', 'N', 'L', '2'};
+constexpr std::size_t WRITE_BATCH_RECORDS = 4096;
+
+}  // namespace
+
+EventJournal::EventJournal(std::chrono::microseconds durability_window,
+                           std::size_t buffer_records)
+    : durability_window_(durability_window)
+    , ring_(buffer_records)
+    , batch_(WRITE_BATCH_RECORDS) {}
+
+EventJournal::~EventJournal() {
+    close();
+}
+
+bool EventJournal::open(const std::string& filename, std::vector<JournalRecord>* recovered) {
+    if (fd_ >= 0) return false;
+
+    // Keep only the intact prefix of an existing journal
+    std::vector<JournalRecord> local;
+    std::vector<JournalRecord>& existing = recovered ? *recovered : local;
+    existing.clear();
+    std::ifstream probe(filename, std::ios::binary | std::ios::ate);
+    std::streamoff size = probe.is_open() ? static_cast<std::streamoff>(probe.tellg()) : 0;
+    bool exists = size > 0;
+    if (exists) {
+        if (!read_records(filename, existing)) return false;
+        // A crash while writing the header leaves a partial magic; start over
+        off_t valid_size = 0;
+        if (size >= static_cast<std::streamoff>(sizeof(JOURNAL_MAGIC))) {
+            valid_size = sizeof(JOURNAL_MAGIC) + existing.size() * sizeof(JournalRecord);
+        } else {
+            exists = false;
+        }
+        if (::truncate(filename.c_str(), valid_size) != 0) return false;
+    }
+
+    fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd_ < 0) return false;
+
+    if (!exists) {
+        if (::write(fd_, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != sizeof(JOURNAL_MAGIC) ||
+            ::fdatasync(fd_) != 0) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+    }
+
+    logged_ = 0;
+    next_sequence_ = existing.size();
+    durable_.store(0, std::memory_order_release);
+    failed_.store(false, std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    writer_ = std::thread(&EventJournal::run, this);
+    return true;
+}
+
+void EventJournal::close() {
+    if (fd_ < 0) return;
+
+    running_.store(false, std::memory_order_release);
+    if (writer_.joinable()) writer_.join();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+void EventJournal::log_add(const Order& order) {
+    JournalRecord record;
+    record.event = static_cast<uint8_t>(JournalEvent::Add);
+    record.is_buy = order.is_buy() ? 1 : 0;
+    record.order_id = order.get_order_id();
+    record.quantity = order.get_quantity();
+    record.price = order.get_price();
+    record.aux = order.get_timestamp().count();
+    append(record);
+}
+
+void EventJournal::log_cancel(int order_id) {
+    JournalRecord record;
+    record.event = static_cast<uint8_t>(JournalEvent::Cancel);
+    record.order_id = order_id;
+    append(record);
+}
+
+void EventJournal::log_amend(int order_id, double new_price, int new_quantity) {
+    JournalRecord record;
+    record.event = static_cast<uint8_t>(JournalEvent::Amend);
+    record.order_id = order_id;
+    record.quantity = new_quantity;
+    record.price = new_price;
+    append(record);
+}
+
+void EventJournal::log_fill(int bid_id, int ask_id, double price, int quantity) {
+    JournalRecord record;
+    record.event = static_cast<uint8_t>(JournalEvent::Fill);
+    record.order_id = bid_id;
+    record.quantity = quantity;
+    record.price = price;
+    record.aux = ask_id;
+    append(record);
+}
+
+void EventJournal::flush() {
+    if (fd_ < 0) return;
+
+    flush_requested_.store(true, std::memory_order_release);
+    while (durable_.load(std::memory_order_acquire) < logged_ &&
+           !failed_.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    flush_requested_.store(false, std::memory_order_release);
+}
+
+bool EventJournal::read_records(const std::string& filename, std::vector<JournalRecord>& records) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    char magic[sizeof(JOURNAL_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    std::size_t header = static_cast<std::size_t>(file.gcount());
+    if (std::memcmp(magic, JOURNAL_MAGIC, header) != 0) return false;
+    if (header < sizeof(magic)) return true;  // Header never completed; no records
+
+    std::vector<JournalRecord> chunk(WRITE_BATCH_RECORDS);
+    for (;;) {
+        file.read(reinterpret_cast<char*>(chunk.data()), chunk.size() * sizeof(JournalRecord));
+        std::size_t count = file.gcount() / sizeof(JournalRecord);
+        for (std::size_t i = 0; i < count; ++i) {
+            // Torn or corrupt tail, or a gap in the sequence
+            if (chunk[i].checksum != checksum(chunk[i])) return true;
+            if (chunk[i].sequence != records.size()) return true;
+            records.push_back(chunk[i]);
+        }
+        if (count < chunk.size()) return true;
+    }
+}
+
+void EventJournal::replay(OrderBook& book, const std::vector<JournalRecord>& records) {
+    for (const auto& record : records) {
+        switch (static_cast<JournalEvent>(record.event)) {
+            case JournalEvent::Add:
+                book.add_order(Order(record.order_id, record.price, record.quantity,
+                                     record.is_buy != 0, std::chrono::nanoseconds(record.aux)));
+                break;
+            case JournalEvent::Cancel:
+                book.cancel_order(record.order_id);
+                break;
+            case JournalEvent::Amend:
+                book.amend_order(record.order_id, record.price, record.quantity);
+                break;
+            case JournalEvent::Fill:
+                // Fills are re-derived by matching; they are journaled for audit only
+                break;
+        }
+    }
+}
+
+void EventJournal::append(JournalRecord record) {
+    // Nothing drains the ring unless the writer is running
+    if (fd_ < 0 || !running_.load(std::memory_order_relaxed)) {
+        failed_.store(true, std::memory_order_release);
+        return;
+    }
+
+    record.sequence = next_sequence_++;
+    record.input_position = input_position_;
+
+    // Back-pressure: the writer is behind by a full buffer
+    while (!ring_.try_push(record)) {
+        std::this_thread::yield();
+    }
+    ++logged_;
+}
+
+void EventJournal::run() {
+    using clock = std::chrono::steady_clock;
+
+    uint64_t written = 0;
+    bool dirty = false;
+    clock::time_point first_unsynced;
+    auto idle_sleep = std::min(durability_window_ / 4, std::chrono::microseconds(50));
+
+    for (;;) {
+        bool stopping = !running_.load(std::memory_order_acquire);
+        JournalRecord record;
+
+        // Fail-stop: anything written after an error could follow a gap
+        if (failed_.load(std::memory_order_acquire)) {
+            while (ring_.try_pop(record)) {}
+            if (stopping) break;
+            std::this_thread::sleep_for(idle_sleep);
+            continue;
+        }
+
+        std::size_t count = 0;
+        while (count < batch_.size() && ring_.try_pop(record)) {
+            record.checksum = checksum(record);
+            batch_[count++] = record;
+        }
+
+        if (count > 0) {
+            if (!write_batch(count)) {
+                failed_.store(true, std::memory_order_release);
+                continue;
+            }
+            if (!dirty) first_unsynced = clock::now();
+            written += count;
+            dirty = true;
+        }
+
+        // Group commit: one fdatasync covers everything written since the last one
+        if (dirty && (stopping || flush_requested_.load(std::memory_order_acquire) ||
+                      clock::now() - first_unsynced >= durability_window_)) {
+            if (::fdatasync(fd_) != 0) {
+                failed_.store(true, std::memory_order_release);
+                continue;
+            }
+            durable_.store(written, std::memory_order_release);
+            dirty = false;
+        }
+
+        if (count == 0) {
+            if (stopping) break;
+            std::this_thread::sleep_for(idle_sleep);
+        }
+    }
+}
+
+bool EventJournal::write_batch(std::size_t count) {
+    const char* data = reinterpret_cast<const char*>(batch_.data());
+    std::size_t remaining = count * sizeof(JournalRecord);
+    while (remaining > 0) {
+        ssize_t n = ::write(fd_, data, remaining);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        remaining -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+uint32_t EventJournal::checksum(const JournalRecord& record) {
+    // FNV-1a over the record with the checksum field zeroed
+    JournalRecord copy = record;
+    copy.checksum = 0;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&copy);
+
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < sizeof(copy); ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,25 @@
+#include "fenwick_tree.hpp"
+
+void FenwickTree::push_back(int64_t value) {
+    // Node i covers (i - lowbit(i), i], all of which already exist except i itself
+    std::size_t i = tree_.size();
+    tree_.push_back(value + prefix_sum(i - 1) - prefix_sum(i - lowbit(i)));
+}
+
+void FenwickTree::add(std::size_t index, int64_t delta) {
+    for (std::size_t i = index + 1; i < tree_.size(); i += lowbit(i)) {
+        tree_[i] += delta;
+    }
+}
+
+int64_t FenwickTree::prefix_sum(std::size_t count) const {
+    int64_t sum = 0;
+    for (std::size_t i = count; i > 0; i -= lowbit(i)) {
+        sum += tree_[i];
+    }
+    return sum;
+}
+
+int64_t FenwickTree::value(std::size_t index) const {
+    return prefix_sum(index + 1) - prefix_sum(index);
+}
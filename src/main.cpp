@@ -1,15 +1,20 @@
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <vector>
+#include <memory>
 #include "order_book.hpp"
+#include "event_journal.hpp"
 #include "csv_parser.hpp"
 #include "data_generator.hpp"
 
 void print_usage(const char* program_name) {
-    std::cout << "Usage: " << program_name << " <input_file> [--generate <num_orders>]\n"
+    std::cout << "Usage: " << program_name
+              << " <input_file> [--generate <num_orders>] [--journal <journal_file>]\n"
               << "Options:\n"
               << "  --generate <num_orders>  Generate synthetic order data\n"
+              << "  --journal <journal_file> Write-ahead journal; recovers the book on restart\n"
               << "  <input_file>            Input CSV file with orders\n";
 }
 
@@ -41,12 +46,21 @@ int main(int argc, char* argv[]) {
     OrderBook book;
 
     // Handle command line arguments
-    if (argc > 2 && std::string(argv[2]) == "--generate") {
-        if (argc != 4) {
+    int num_orders = 0;
+    std::string journal_file;
+    for (int i = 2; i < argc; i += 2) {
+        std::string option = argv[i];
+        if (i + 1 >= argc || (option != "--generate" && option != "--journal")) {
             print_usage(argv[0]);
             return 1;
         }
-        int num_orders = std::stoi(argv[3]);
+        if (option == "--generate") {
+            num_orders = std::stoi(argv[i + 1]);
+        } else {
+            journal_file = argv[i + 1];
+        }
+    }
+    if (num_orders > 0) {
         generate_test_data(input_file, num_orders);
     }
 
@@ -56,12 +70,36 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Recover from the journal, then log everything processed from here on.
+    // Records are tagged with their 1-based input row, so the run resumes after
+    // the last row recovered; rejected rows are simply validated again.
+    std::unique_ptr<EventJournal> journal;
+    std::size_t resume_row = 0;
+    if (!journal_file.empty()) {
+        journal = std::make_unique<EventJournal>();
+        std::vector<JournalRecord> records;
+        if (!journal->open(journal_file, &records)) {
+            std::cerr << "Failed to open journal " << journal_file << "\n";
+            return 1;
+        }
+        EventJournal::replay(book, records);
+        if (!records.empty()) {
+            resume_row = std::min<std::size_t>(records.back().input_position, orders.size());
+            std::cout << "Recovered " << records.size() << " journal records from "
+                      << journal_file << "\n";
+        }
+        book.set_journal(journal.get());
+    }
+
     // Process orders
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    for (const auto& order : orders) {
-        book.add_order(order);
+    for (std::size_t row = resume_row; row < orders.size(); ++row) {
+        if (journal) journal->set_input_position(row + 1);
+        book.add_order(orders[row]);
     }
+    std::size_t recovered_orders = resume_row;
+    std::size_t processed_orders = orders.size() - resume_row;
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
@@ -69,7 +107,8 @@ int main(int argc, char* argv[]) {
     // Print statistics
     std::cout << "\nOrder Book Statistics:\n"
               << "-------------------\n"
-              << "Total orders processed: " << orders.size() << "\n"
+              << "Orders recovered from journal: " << recovered_orders << "\n"
+              << "Total orders processed: " << processed_orders << "\n"
               << "Processing time: " << duration.count() << " microseconds\n"
               << "Average latency per order: " << book.get_average_execution_latency() << " nanoseconds\n"
               << "Current spread: " << book.get_spread() << "\n"
@@ -78,10 +117,18 @@ int main(int argc, char* argv[]) {
               << "Total bid volume: " << book.get_bid_volume() << "\n"
               << "Total ask volume: " << book.get_ask_volume() << "\n";
 
+    if (journal) journal->close();
+
     // Export final book state
     std::string output_file = "book_state.csv";
     book.export_to_csv(output_file);
     std::cout << "\nOrder book state exported to " << output_file << "\n";
 
+    if (journal && journal->has_failed()) {
+        std::cerr << "Journal " << journal_file
+                  << " failed; this run cannot be fully recovered from it\n";
+        return 1;
+    }
+
     return 0;
 } 
\ No newline at end of file
@@ -1,14 +1,22 @@
 #include "order_book.hpp"
+#include "event_journal.hpp"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 
-OrderBook::OrderBook() : total_matches_(0) {}
+OrderBook::OrderBook() : journal_(nullptr), total_matches_(0) {}
 
 bool OrderBook::add_order(const Order& order) {
     if (!order.is_valid()) return false;
+    if (order_index_.count(order.get_order_id())) return false;  // Id already resting
 
+    if (journal_) journal_->log_add(order);
+    insert_order(order);
+    return true;
+}
+
+void OrderBook::insert_order(const Order& order) {
     auto start_time = std::chrono::high_resolution_clock::now();
     
     if (order.is_buy()) {
@@ -16,39 +24,57 @@ bool OrderBook::add_order(const Order& order) {
     } else {
         asks_[order.get_price()].push_back(order);
     }
+    track_order(order);
 
     match_orders();
 
     auto end_time = std::chrono::high_resolution_clock::now();
     execution_latencies_.push_back(
         std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time));
-    
-    return true;
 }
 
 bool OrderBook::cancel_order(int order_id) {
-    // Search in both bids and asks
-    for (auto& [price, orders] : bids_) {
-        auto it = std::find_if(orders.begin(), orders.end(),
-            [order_id](const Order& order) { return order.get_order_id() == order_id; });
-        if (it != orders.end()) {
-            orders.erase(it);
-            if (orders.empty()) bids_.erase(price);
-            return true;
-        }
-    }
+    auto found = order_index_.find(order_id);
+    if (found == order_index_.end()) return false;
 
-    for (auto& [price, orders] : asks_) {
-        auto it = std::find_if(orders.begin(), orders.end(),
-            [order_id](const Order& order) { return order.get_order_id() == order_id; });
-        if (it != orders.end()) {
-            orders.erase(it);
-            if (orders.empty()) asks_.erase(price);
-            return true;
-        }
+    if (journal_) journal_->log_cancel(order_id);
+
+    bool is_buy = found->second.is_buy;
+    double price = found->second.price;
+    auto& orders = level_orders(is_buy, price);
+    orders.erase(orders.begin() + level_index(found->second));
+    untrack_order(order_id);
+    erase_level_if_empty(is_buy, price);
+    return true;
+}
+
+bool OrderBook::amend_order(int order_id, double new_price, int new_quantity) {
+    if (new_price <= 0.0 || new_quantity <= 0) return false;
+
+    auto found = order_index_.find(order_id);
+    if (found == order_index_.end()) return false;
+
+    if (journal_) journal_->log_amend(order_id, new_price, new_quantity);
+
+    bool is_buy = found->second.is_buy;
+    double price = found->second.price;
+    auto& orders = level_orders(is_buy, price);
+    auto it = orders.begin() + level_index(found->second);
+
+    // Shrinking in place keeps time priority
+    if (new_price == price && new_quantity <= it->get_quantity()) {
+        update_tracked_quantity(order_id, new_quantity - it->get_quantity());
+        it->set_quantity(new_quantity);
+        return true;
     }
 
-    return false;
+    // Any other change loses priority: re-enter at the back of the new level
+    Order amended(order_id, new_price, new_quantity, is_buy, it->get_timestamp());
+    orders.erase(it);
+    untrack_order(order_id);
+    erase_level_if_empty(is_buy, price);
+    insert_order(amended);
+    return true;
 }
 
 void OrderBook::match_orders() {
@@ -75,19 +101,31 @@ void OrderBook::match_orders_at_price(double price) {
         }
         total_matches_++;
     }
+
+    // Drop exhausted levels so the next iteration sees the new best prices
+    if (bid_orders.empty()) bids_.erase(bids_.begin());
+    if (ask_orders.empty()) asks_.erase(asks_.begin());
 }
 
 bool OrderBook::try_match_orders(Order& bid, Order& ask) {
     int match_quantity = std::min(bid.get_quantity(), ask.get_quantity());
     
+    int bid_id = bid.get_order_id();
+    int ask_id = ask.get_order_id();
+    
     bid.set_quantity(bid.get_quantity() - match_quantity);
     ask.set_quantity(ask.get_quantity() - match_quantity);
+    update_tracked_quantity(bid_id, -match_quantity);
+    update_tracked_quantity(ask_id, -match_quantity);
+    if (journal_) journal_->log_fill(bid_id, ask_id, ask.get_price(), match_quantity);
 
     if (bid.get_quantity() == 0) {
         bids_.begin()->second.erase(bids_.begin()->second.begin());
+        untrack_order(bid_id);
     }
     if (ask.get_quantity() == 0) {
         asks_.begin()->second.erase(asks_.begin()->second.begin());
+        untrack_order(ask_id);
     }
 
     return true;
@@ -144,6 +182,20 @@ double OrderBook::get_spread() const {
     return get_best_ask() - get_best_bid();
 }
 
+int OrderBook::queue_position(int order_id) const {
+    auto found = order_index_.find(order_id);
+    if (found == order_index_.end()) return -1;
+    const OrderSlot& slot = found->second;
+    return static_cast<int>(slot.queue->count.prefix_sum(slot.slot));
+}
+
+int OrderBook::volume_ahead(int order_id) const {
+    auto found = order_index_.find(order_id);
+    if (found == order_index_.end()) return -1;
+    const OrderSlot& slot = found->second;
+    return static_cast<int>(slot.queue->volume.prefix_sum(slot.slot));
+}
+
 double OrderBook::get_average_execution_latency() const {
     if (execution_latencies_.empty()) return 0.0;
     
@@ -191,4 +243,73 @@ void OrderBook::export_to_csv(const std::string& filename) const {
                  << "," << order.get_quantity() << "\n";
         }
     }
-} 
\ No newline at end of file
+}
+
+std::vector<Order>& OrderBook::level_orders(bool is_buy, double price) {
+    return is_buy ? bids_.at(price) : asks_.at(price);
+}
+
+std::size_t OrderBook::level_index(const OrderSlot& slot) const {
+    // Levels hold exactly the live orders in slot order, so the number of live
+    // slots ahead is the order's index in the level
+    return static_cast<std::size_t>(slot.queue->count.prefix_sum(slot.slot));
+}
+
+void OrderBook::erase_level_if_empty(bool is_buy, double price) {
+    if (is_buy) {
+        auto it = bids_.find(price);
+        if (it != bids_.end() && it->second.empty()) bids_.erase(it);
+    } else {
+        auto it = asks_.find(price);
+        if (it != asks_.end() && it->second.empty()) asks_.erase(it);
+    }
+}
+
+void OrderBook::track_order(const Order& order) {
+    LevelQueue& queue = order.is_buy() ? bid_queues_[order.get_price()]
+                                       : ask_queues_[order.get_price()];
+    order_index_[order.get_order_id()] =
+        OrderSlot{order.is_buy(), order.get_price(), &queue, queue.count.size()};
+    queue.volume.push_back(order.get_quantity());
+    queue.count.push_back(1);
+    queue.live++;
+}
+
+void OrderBook::update_tracked_quantity(int order_id, int delta) {
+    auto found = order_index_.find(order_id);
+    if (found == order_index_.end() || delta == 0) return;
+    found->second.queue->volume.add(found->second.slot, delta);
+}
+
+void OrderBook::untrack_order(int order_id) {
+    auto found = order_index_.find(order_id);
+    if (found == order_index_.end()) return;
+
+    OrderSlot slot = found->second;
+    order_index_.erase(found);
+
+    LevelQueue& queue = *slot.queue;
+    if (--queue.live == 0) {
+        if (slot.is_buy) bid_queues_.erase(slot.price);
+        else ask_queues_.erase(slot.price);
+        return;
+    }
+
+    queue.volume.add(slot.slot, -queue.volume.value(slot.slot));
+    queue.count.add(slot.slot, -1);
+
+    // Dead slots only ever accumulate; rebuild once they dominate the level
+    if (queue.count.size() >= 64 && queue.live * 2 < queue.count.size()) {
+        compact_queue(slot.is_buy, slot.price, queue);
+    }
+}
+
+void OrderBook::compact_queue(bool is_buy, double price, LevelQueue& queue) {
+    queue.volume.clear();
+    queue.count.clear();
+    for (const auto& order : level_orders(is_buy, price)) {
+        order_index_[order.get_order_id()].slot = queue.count.size();
+        queue.volume.push_back(order.get_quantity());
+        queue.count.push_back(1);
+    }
+}
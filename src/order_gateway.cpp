@@ -0,0 +1,132 @@
+#include "order_gateway.hpp"
+
+OrderGateway::OrderGateway(OrderBook& book, int num_producers,
+                           std::size_t queue_capacity, std::size_t ack_capacity)
+    : book_(book)
+    , requests_(queue_capacity) {
+    acks_.reserve(num_producers);
+    for (int i = 0; i < num_producers; ++i) {
+        acks_.push_back(std::make_unique<SpscRing<OrderAck>>(ack_capacity));
+    }
+}
+
+OrderGateway::~OrderGateway() {
+    stop();
+}
+
+void OrderGateway::start() {
+    if (requests_.is_closed() || running_.exchange(true)) return;
+    matcher_ = std::thread(&OrderGateway::run, this);
+}
+
+void OrderGateway::stop() {
+    if (!running_.load(std::memory_order_acquire) || stopping_.exchange(true)) return;
+
+    // Close first so the drain target is final before the matcher sees it
+    issued_.store(requests_.close(), std::memory_order_relaxed);
+    running_.store(false, std::memory_order_release);
+    if (matcher_.joinable()) matcher_.join();
+}
+
+bool OrderGateway::submit_add(int producer_id, const Order& order, uint64_t* sequence) {
+    OrderRequest request;
+    request.type = RequestType::Add;
+    request.producer_id = producer_id;
+    request.order_id = order.get_order_id();
+    request.price = order.get_price();
+    request.quantity = order.get_quantity();
+    request.is_buy = order.is_buy();
+    request.timestamp = order.get_timestamp();
+    return submit(request, sequence);
+}
+
+bool OrderGateway::submit_cancel(int producer_id, int order_id, uint64_t* sequence) {
+    OrderRequest request;
+    request.type = RequestType::Cancel;
+    request.producer_id = producer_id;
+    request.order_id = order_id;
+    return submit(request, sequence);
+}
+
+bool OrderGateway::submit_amend(int producer_id, int order_id, double new_price,
+                                int new_quantity, uint64_t* sequence) {
+    OrderRequest request;
+    request.type = RequestType::Amend;
+    request.producer_id = producer_id;
+    request.order_id = order_id;
+    request.price = new_price;
+    request.quantity = new_quantity;
+    return submit(request, sequence);
+}
+
+bool OrderGateway::poll_ack(int producer_id, OrderAck& ack) {
+    if (producer_id < 0 || producer_id >= static_cast<int>(acks_.size())) return false;
+    return acks_[producer_id]->try_pop(ack);
+}
+
+bool OrderGateway::apply(OrderBook& book, const OrderRequest& request) {
+    switch (request.type) {
+        case RequestType::Add:
+            return book.add_order(Order(request.order_id, request.price, request.quantity,
+                                        request.is_buy, request.timestamp));
+        case RequestType::Cancel:
+            return book.cancel_order(request.order_id);
+        case RequestType::Amend:
+            return book.amend_order(request.order_id, request.price, request.quantity);
+    }
+    return false;
+}
+
+bool OrderGateway::submit(OrderRequest request, uint64_t* sequence) {
+    if (request.producer_id < 0 || request.producer_id >= static_cast<int>(acks_.size())) {
+        return false;
+    }
+    if (!running_.load(std::memory_order_acquire)) return false;
+
+    uint64_t ticket = 0;
+    if (!requests_.try_push(request, ticket)) return false;
+    if (sequence) *sequence = ticket;
+    return true;
+}
+
+void OrderGateway::run() {
+    OrderRequest request;
+    for (;;) {
+        if (requests_.try_pop(request)) {
+            process(request, next_sequence_++);
+            continue;
+        }
+        // Queue is empty; once stop() has been requested, apply every ticket
+        // issued before close(), including ones a producer is still publishing
+        if (!running_.load(std::memory_order_acquire)) {
+            uint64_t issued = issued_.load(std::memory_order_relaxed);
+            while (next_sequence_ < issued) {
+                if (requests_.try_pop(request)) {
+                    process(request, next_sequence_++);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            break;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void OrderGateway::process(const OrderRequest& request, uint64_t sequence) {
+    OrderAck ack;
+    ack.sequence = sequence;
+    ack.request = request;
+    ack.accepted = apply(book_, request);
+    processed_.fetch_add(1, std::memory_order_release);
+
+    // Wait for the producer to make room; once stopping, drop rather than hang
+    auto& ring = *acks_[request.producer_id];
+    while (!ring.try_push(ack)) {
+        if (!running_.load(std::memory_order_acquire)) {
+            dropped_acks_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
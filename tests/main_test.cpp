@@ -1,6 +1,21 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <random>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "event_journal.hpp"
 #include "order_book.hpp"
+#include "order_gateway.hpp"
 
 class OrderBookTest : public ::testing::Test {
 protected:
@@ -77,6 +92,613 @@ TEST_F(OrderBookTest, InvalidOrder) {
     EXPECT_FALSE(book.add_order(order2));
 }
 
+TEST_F(OrderBookTest, AmendOrder) {
+    EXPECT_TRUE(book.add_order(Order(1, 100.0, 10, true, timestamp)));
+    EXPECT_TRUE(book.add_order(Order(2, 100.0, 10, true, timestamp)));
+
+    // Shrink in place
+    EXPECT_TRUE(book.amend_order(1, 100.0, 4));
+    EXPECT_EQ(book.get_bid_volume(), 14);
+
+    // Reprice through the ask side and trade
+    EXPECT_TRUE(book.add_order(Order(3, 101.0, 5, false, timestamp)));
+    EXPECT_TRUE(book.amend_order(2, 101.0, 10));
+    EXPECT_EQ(book.get_ask_volume(), 0);
+    EXPECT_EQ(book.get_bid_volume(), 9);
+    EXPECT_DOUBLE_EQ(book.get_best_bid(), 101.0);
+
+    EXPECT_FALSE(book.amend_order(42, 100.0, 1));
+    EXPECT_FALSE(book.amend_order(1, 100.0, 0));
+}
+
+TEST_F(OrderBookTest, QueuePositionAndVolumeAhead) {
+    EXPECT_TRUE(book.add_order(Order(1, 100.0, 10, true, timestamp)));
+    EXPECT_TRUE(book.add_order(Order(2, 100.0, 20, true, timestamp)));
+    EXPECT_TRUE(book.add_order(Order(3, 100.0, 30, true, timestamp)));
+    EXPECT_TRUE(book.add_order(Order(4, 99.0, 5, true, timestamp)));
+
+    EXPECT_EQ(book.queue_position(1), 0);
+    EXPECT_EQ(book.queue_position(3), 2);
+    EXPECT_EQ(book.volume_ahead(3), 30);
+    EXPECT_EQ(book.volume_ahead(4), 0);
+
+    // Partial fill of the front order
+    EXPECT_TRUE(book.add_order(Order(5, 100.0, 4, false, timestamp)));
+    EXPECT_EQ(book.volume_ahead(3), 26);
+
+    // Cancel and full fill
+    EXPECT_TRUE(book.cancel_order(2));
+    EXPECT_EQ(book.queue_position(3), 1);
+    EXPECT_TRUE(book.add_order(Order(6, 100.0, 6, false, timestamp)));
+    EXPECT_EQ(book.queue_position(1), -1);
+    EXPECT_EQ(book.queue_position(3), 0);
+    EXPECT_EQ(book.volume_ahead(3), 0);
+
+    // Repricing goes to the back of the new level
+    EXPECT_TRUE(book.amend_order(3, 99.0, 30));
+    EXPECT_EQ(book.queue_position(3), 1);
+    EXPECT_EQ(book.volume_ahead(3), 5);
+
+    EXPECT_EQ(book.queue_position(42), -1);
+    EXPECT_EQ(book.volume_ahead(42), -1);
+}
+
+TEST_F(OrderBookTest, QueueQueriesMatchLinearScan) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> price_dist(0, 4);
+    std::uniform_int_distribution<int> qty_dist(1, 100);
+    std::uniform_int_distribution<int> action_dist(0, 9);
+
+    // Reference price-time book; bid and ask prices overlap so orders cross
+    using Fifo = std::vector<std::pair<int, int>>;  // (order id, remaining quantity)
+    std::map<double, Fifo, std::greater<double>> bids;
+    std::map<double, Fifo> asks;
+    std::map<int, std::pair<bool, double>> live;
+    int next_id = 1;
+    int fills = 0;
+
+    auto fifo_of = [&](bool is_buy, double price) -> Fifo& {
+        return is_buy ? bids[price] : asks[price];
+    };
+    auto drop_if_empty = [&](bool is_buy, double price) {
+        if (is_buy && bids[price].empty()) bids.erase(price);
+        if (!is_buy && asks[price].empty()) asks.erase(price);
+    };
+    auto match = [&] {
+        while (!bids.empty() && !asks.empty() && bids.begin()->first >= asks.begin()->first) {
+            auto& bid = bids.begin()->second.front();
+            auto& ask = asks.begin()->second.front();
+            int quantity = std::min(bid.second, ask.second);
+            bid.second -= quantity;
+            ask.second -= quantity;
+            fills++;
+            if (bid.second == 0) {
+                live.erase(bid.first);
+                bids.begin()->second.erase(bids.begin()->second.begin());
+            }
+            if (ask.second == 0) {
+                live.erase(ask.first);
+                asks.begin()->second.erase(asks.begin()->second.begin());
+            }
+            if (bids.begin()->second.empty()) bids.erase(bids.begin());
+            if (asks.begin()->second.empty()) asks.erase(asks.begin());
+        }
+    };
+
+    for (int step = 0; step < 20000; ++step) {
+        int action = action_dist(rng);
+        if (action < 5 || live.empty()) {
+            bool is_buy = rng() % 2 == 0;
+            double price = is_buy ? 97.0 + price_dist(rng) : 99.0 + price_dist(rng);
+            int id = next_id++;
+            int quantity = qty_dist(rng);
+            EXPECT_TRUE(book.add_order(Order(id, price, quantity, is_buy, timestamp)));
+            fifo_of(is_buy, price).emplace_back(id, quantity);
+            live[id] = {is_buy, price};
+            match();
+        } else {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+            int id = it->first;
+            auto [is_buy, price] = it->second;
+            auto& fifo = fifo_of(is_buy, price);
+            auto entry = std::find_if(fifo.begin(), fifo.end(),
+                [&](const std::pair<int, int>& e) { return e.first == id; });
+            if (action < 8) {
+                EXPECT_TRUE(book.cancel_order(id));
+                fifo.erase(entry);
+                drop_if_empty(is_buy, price);
+                live.erase(it);
+            } else if (action < 9) {
+                // Shrink in place
+                EXPECT_TRUE(book.amend_order(id, price, 1));
+                entry->second = 1;
+            } else {
+                // Reprice to the back of another level, possibly crossing
+                double new_price = 98.0 + price_dist(rng);
+                int quantity = qty_dist(rng);
+                EXPECT_TRUE(book.amend_order(id, new_price, quantity));
+                if (new_price == price && quantity <= entry->second) {
+                    entry->second = quantity;  // Same price and smaller: stays in place
+                } else {
+                    fifo.erase(entry);
+                    drop_if_empty(is_buy, price);
+                    fifo_of(is_buy, new_price).emplace_back(id, quantity);
+                    live[id] = {is_buy, new_price};
+                    match();
+                }
+            }
+        }
+
+        if (step % 500 != 499) continue;
+        int bid_volume = 0;
+        int ask_volume = 0;
+        auto check = [&](const Fifo& fifo, int& volume) {
+            int ahead = 0;
+            for (size_t i = 0; i < fifo.size(); ++i) {
+                EXPECT_EQ(book.queue_position(fifo[i].first), static_cast<int>(i));
+                EXPECT_EQ(book.volume_ahead(fifo[i].first), ahead);
+                ahead += fifo[i].second;
+            }
+            volume += ahead;
+        };
+        for (const auto& [price, fifo] : bids) check(fifo, bid_volume);
+        for (const auto& [price, fifo] : asks) check(fifo, ask_volume);
+        EXPECT_EQ(book.get_bid_volume(), bid_volume);
+        EXPECT_EQ(book.get_ask_volume(), ask_volume);
+    }
+
+    // Filled orders are gone from the index
+    for (int id = 1; id < next_id; ++id) {
+        if (!live.count(id)) EXPECT_EQ(book.queue_position(id), -1);
+    }
+    EXPECT_GT(fills, 1000);
+}
+
+TEST(OrderGatewayTest, SingleProducerAcks) {
+    OrderBook book;
+    OrderGateway gateway(book, 1);
+    EXPECT_FALSE(gateway.submit_cancel(0, 1));  // Not started
+    gateway.start();
+
+    uint64_t seq = 0;
+    EXPECT_TRUE(gateway.submit_add(0, Order(1, 100.0, 10, true, std::chrono::nanoseconds(0)), &seq));
+    EXPECT_EQ(seq, 0u);
+    EXPECT_TRUE(gateway.submit_cancel(0, 1, &seq));
+    EXPECT_EQ(seq, 1u);
+    EXPECT_TRUE(gateway.submit_cancel(0, 1, &seq));
+    EXPECT_FALSE(gateway.submit_cancel(5, 1));
+
+    std::vector<OrderAck> acks;
+    OrderAck ack;
+    while (acks.size() < 3) {
+        if (gateway.poll_ack(0, ack)) acks.push_back(ack);
+    }
+    gateway.stop();
+
+    EXPECT_FALSE(gateway.submit_cancel(0, 1));  // Stopped
+    EXPECT_FALSE(gateway.poll_ack(0, ack));
+
+    EXPECT_EQ(acks[0].sequence, 0u);
+    EXPECT_TRUE(acks[0].accepted);
+    EXPECT_TRUE(acks[1].accepted);
+    EXPECT_FALSE(acks[2].accepted);  // Already cancelled
+    EXPECT_EQ(book.get_bid_volume(), 0);
+}
+
+// Stopping while producers are mid-submit must still apply and ack every
+// request that was accepted, and nothing else
+TEST(OrderGatewayTest, StopWhileSubmitting) {
+    constexpr int kProducers = 8;
+
+    OrderBook book;
+    OrderGateway gateway(book, kProducers, 256, 1 << 16);
+    gateway.start();
+
+    std::atomic<bool> stopped{false};
+    std::vector<std::vector<uint64_t>> accepted(kProducers);
+    std::vector<std::vector<uint64_t>> acked(kProducers);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            OrderAck ack;
+            int next = 0;
+            while (!stopped.load()) {
+                if (gateway.poll_ack(p, ack)) acked[p].push_back(ack.sequence);
+                uint64_t seq = 0;
+                if (gateway.submit_cancel(p, p * 1000000 + next, &seq)) {
+                    accepted[p].push_back(seq);
+                    ++next;
+                }
+            }
+            // The matcher has been joined, so every ack is already in the ring
+            while (gateway.poll_ack(p, ack)) acked[p].push_back(ack.sequence);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gateway.stop();
+    stopped.store(true);
+    for (auto& t : producers) t.join();
+
+    std::vector<uint64_t> all_accepted;
+    std::vector<uint64_t> all_acked;
+    for (int p = 0; p < kProducers; ++p) {
+        EXPECT_EQ(acked[p], accepted[p]);
+        all_accepted.insert(all_accepted.end(), accepted[p].begin(), accepted[p].end());
+        all_acked.insert(all_acked.end(), acked[p].begin(), acked[p].end());
+    }
+    std::sort(all_acked.begin(), all_acked.end());
+    ASSERT_FALSE(all_acked.empty());
+    for (size_t i = 0; i < all_acked.size(); ++i) ASSERT_EQ(all_acked[i], i);
+    EXPECT_EQ(all_accepted.size(), all_acked.size());
+    EXPECT_EQ(gateway.get_processed_count(), all_acked.size());
+    EXPECT_EQ(gateway.get_dropped_ack_count(), 0u);
+}
+
+// Many producers race; replaying their acknowledged requests in sequence order
+// on a fresh book must reproduce every ack and the final book exactly.
+TEST(OrderGatewayTest, MultiProducerDeterministicReplay) {
+    constexpr int kProducers = 16;
+    constexpr int kRequestsPerProducer = 2000;
+
+    OrderBook book;
+    OrderGateway gateway(book, kProducers, 1024, 1024);
+    gateway.start();
+
+    std::vector<std::vector<OrderAck>> acks(kProducers);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            auto& mine = acks[p];
+            OrderAck ack;
+            int submitted = 0;
+            while (submitted < kRequestsPerProducer || static_cast<int>(mine.size()) < submitted) {
+                if (gateway.poll_ack(p, ack)) mine.push_back(ack);
+                if (submitted == kRequestsPerProducer) continue;
+
+                int order_id = p * kRequestsPerProducer + submitted + 1;
+                bool ok;
+                switch (submitted % 4) {
+                    case 3:
+                        ok = gateway.submit_cancel(p, order_id - 2);
+                        break;
+                    case 2:
+                        ok = gateway.submit_amend(p, order_id - 1, 99.0 + (submitted % 7) * 0.5, 7);
+                        break;
+                    default:
+                        ok = gateway.submit_add(p, Order(order_id, 98.0 + (order_id % 9) * 0.5,
+                                                         1 + order_id % 50, (order_id + p) % 2 == 0,
+                                                         std::chrono::nanoseconds(order_id)));
+                        break;
+                }
+                if (ok) ++submitted;
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    gateway.stop();
+
+    std::vector<OrderAck> all;
+    for (const auto& mine : acks) all.insert(all.end(), mine.begin(), mine.end());
+    std::sort(all.begin(), all.end(),
+              [](const OrderAck& a, const OrderAck& b) { return a.sequence < b.sequence; });
+
+    ASSERT_EQ(all.size(), static_cast<size_t>(kProducers * kRequestsPerProducer));
+    EXPECT_EQ(gateway.get_dropped_ack_count(), 0u);
+
+    OrderBook replay;
+    for (size_t i = 0; i < all.size(); ++i) {
+        ASSERT_EQ(all[i].sequence, i);
+        EXPECT_EQ(OrderGateway::apply(replay, all[i].request), all[i].accepted);
+    }
+    EXPECT_EQ(replay.get_bid_volume(), book.get_bid_volume());
+    EXPECT_EQ(replay.get_ask_volume(), book.get_ask_volume());
+    EXPECT_DOUBLE_EQ(replay.get_best_bid(), book.get_best_bid());
+    EXPECT_DOUBLE_EQ(replay.get_best_ask(), book.get_best_ask());
+    EXPECT_EQ(replay.get_book_state(), book.get_book_state());
+}
+
+// Deterministic request stream shared by the journaled run and its reference.
+// Returns whether the request was accepted, i.e. journaled as one record.
+static bool apply_journal_test_request(OrderBook& book, int i) {
+    int id = i + 1;
+    switch (i % 5) {
+        case 3:
+            return book.cancel_order(id - 2);
+        case 4:
+            return book.amend_order(id - 3, 99.0 + (i % 7) * 0.5, 1 + i % 13);
+        default:
+            return book.add_order(Order(id, 98.0 + (i * 7 % 11) * 0.5, 1 + i * 31 % 97,
+                                        (i * 3) % 4 < 2, std::chrono::nanoseconds(i)));
+    }
+}
+
+static std::string export_book(const OrderBook& book, const std::string& filename) {
+    book.export_to_csv(filename);
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::remove(filename.c_str());
+    return ss.str();
+}
+
+class EventJournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = ::testing::TempDir() + "lob_journal_test.bin";
+        std::remove(path.c_str());
+    }
+    void TearDown() override { std::remove(path.c_str()); }
+
+    std::string path;
+};
+
+TEST_F(EventJournalTest, ReplayRebuildsBook) {
+    constexpr int kRequests = 3000;
+    OrderBook book;
+    {
+        EventJournal journal(std::chrono::microseconds(200), 256);
+        ASSERT_TRUE(journal.open(path));
+        book.set_journal(&journal);
+        for (int i = 0; i < kRequests; ++i) apply_journal_test_request(book, i);
+        journal.flush();
+        EXPECT_EQ(journal.get_durable_count(), journal.get_logged_count());
+        EXPECT_FALSE(journal.has_failed());
+        book.set_journal(nullptr);
+    }
+
+    std::vector<JournalRecord> records;
+    ASSERT_TRUE(EventJournal::read_records(path, records));
+    OrderBook recovered;
+    EventJournal::replay(recovered, records);
+
+    EXPECT_EQ(export_book(recovered, path + ".a.csv"), export_book(book, path + ".b.csv"));
+    for (int id = 1; id <= kRequests; ++id) {
+        EXPECT_EQ(recovered.queue_position(id), book.queue_position(id));
+        EXPECT_EQ(recovered.volume_ahead(id), book.volume_ahead(id));
+    }
+}
+
+TEST_F(EventJournalTest, RecoversAfterKill) {
+    constexpr int kFlushed = 4000;
+    constexpr int kTotal = 6000;
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        OrderBook book;
+        EventJournal journal(std::chrono::microseconds(100));
+        if (!journal.open(path)) _exit(1);
+        book.set_journal(&journal);
+        for (int i = 0; i < kFlushed; ++i) apply_journal_test_request(book, i);
+        journal.flush();
+        for (int i = kFlushed; i < kTotal; ++i) apply_journal_test_request(book, i);
+        kill(getpid(), SIGKILL);
+        _exit(1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    ASSERT_EQ(WTERMSIG(status), SIGKILL);
+
+    // Simulate a corrupt record and a torn final write on top of whatever
+    // reached the disk
+    {
+        JournalRecord garbage;
+        garbage.event = static_cast<uint8_t>(JournalEvent::Add);
+        garbage.order_id = 999999;
+        garbage.quantity = 1;
+        garbage.checksum = 0xdeadbeef;
+        garbage.price = 100.0;
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        torn.write(reinterpret_cast<const char*>(&garbage), sizeof(garbage));
+        torn.write("torn-record", 11);
+    }
+
+    std::vector<JournalRecord> records;
+    ASSERT_TRUE(EventJournal::read_records(path, records));
+    OrderBook recovered;
+    EventJournal::replay(recovered, records);
+
+    // Uninterrupted reference run of the same stream
+    std::string reference_path = path + ".ref";
+    {
+        OrderBook book;
+        EventJournal journal;
+        ASSERT_TRUE(journal.open(reference_path));
+        book.set_journal(&journal);
+        for (int i = 0; i < kTotal; ++i) apply_journal_test_request(book, i);
+        book.set_journal(nullptr);
+    }
+    std::vector<JournalRecord> reference_records;
+    ASSERT_TRUE(EventJournal::read_records(reference_path, reference_records));
+    std::remove(reference_path.c_str());
+
+    // The recovered records are a byte-identical prefix of the uninterrupted run
+    ASSERT_LE(records.size(), reference_records.size());
+    EXPECT_EQ(std::memcmp(records.data(), reference_records.data(),
+                          records.size() * sizeof(JournalRecord)), 0);
+    for (const auto& record : records) EXPECT_NE(record.order_id, 999999);
+
+    // Every request accepted before the flush survived the kill
+    int requests = 0;
+    for (const auto& record : records) {
+        if (record.event != static_cast<uint8_t>(JournalEvent::Fill)) requests++;
+    }
+    int flushed_requests = 0;
+    {
+        OrderBook book;
+        for (int i = 0; i < kFlushed; ++i) {
+            if (apply_journal_test_request(book, i)) flushed_requests++;
+        }
+    }
+    EXPECT_GE(requests, flushed_requests);
+
+    // The recovered book equals a live, unjournaled book that processed the
+    // same accepted requests
+    OrderBook reference;
+    for (int i = 0, applied = 0; i < kTotal && applied < requests; ++i) {
+        if (apply_journal_test_request(reference, i)) applied++;
+    }
+    EXPECT_EQ(export_book(recovered, path + ".a.csv"), export_book(reference, path + ".b.csv"));
+    for (int id = 1; id <= kTotal; ++id) {
+        EXPECT_EQ(recovered.queue_position(id), reference.queue_position(id));
+        EXPECT_EQ(recovered.volume_ahead(id), reference.volume_ahead(id));
+    }
+
+    // Reopening drops the torn tail and appends cleanly after the intact prefix
+    {
+        EventJournal journal;
+        ASSERT_TRUE(journal.open(path));
+        journal.log_cancel(1);
+        journal.close();
+    }
+    std::vector<JournalRecord> reopened;
+    ASSERT_TRUE(EventJournal::read_records(path, reopened));
+    ASSERT_EQ(reopened.size(), records.size() + 1);
+    EXPECT_EQ(reopened.back().event, static_cast<uint8_t>(JournalEvent::Cancel));
+}
+
+TEST_F(EventJournalTest, RecoversPartialHeader) {
+    {
+        std::ofstream partial(path, std::ios::binary);
+        partial.write("LOB", 3);
+    }
+    std::vector<JournalRecord> records;
+    EXPECT_TRUE(EventJournal::read_records(path, records));
+    EXPECT_TRUE(records.empty());
+
+    EventJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    journal.log_cancel(7);
+    journal.close();
+    EXPECT_FALSE(journal.has_failed());
+
+    ASSERT_TRUE(EventJournal::read_records(path, records));
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].order_id, 7);
+}
+
+// Test hook into the journal's file descriptor
+struct EventJournalTestAccess {
+    static int fd(const EventJournal& journal) { return journal.fd_; }
+};
+
+TEST_F(EventJournalTest, WriterStopsAfterFirstError) {
+    EventJournal journal(std::chrono::microseconds(100), 64);
+    ASSERT_TRUE(journal.open(path));
+    for (int id = 1; id <= 10; ++id) journal.log_cancel(id);
+    journal.flush();
+    EXPECT_EQ(journal.get_durable_count(), 10u);
+
+    // Swap a read-only descriptor in under the writer so its next write fails
+    int fd = EventJournalTestAccess::fd(journal);
+    int saved = ::dup(fd);
+    int readonly = ::open("/dev/null", O_RDONLY);
+    ASSERT_GE(saved, 0);
+    ASSERT_GE(readonly, 0);
+    ASSERT_EQ(::dup2(readonly, fd), fd);
+    ::close(readonly);
+
+    for (int id = 11; id <= 20; ++id) journal.log_cancel(id);
+    journal.flush();
+    EXPECT_TRUE(journal.has_failed());
+    EXPECT_EQ(journal.get_durable_count(), 10u);
+
+    // Even with a working descriptor back, nothing more reaches the file
+    ASSERT_EQ(::dup2(saved, fd), fd);
+    ::close(saved);
+    for (int id = 21; id <= 30; ++id) journal.log_cancel(id);
+    journal.close();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    EXPECT_EQ(static_cast<size_t>(file.tellg()), 8 + 10 * sizeof(JournalRecord));
+
+    std::vector<JournalRecord> records;
+    ASSERT_TRUE(EventJournal::read_records(path, records));
+    ASSERT_EQ(records.size(), 10u);
+    EXPECT_EQ(records.back().order_id, 10);
+}
+
+TEST_F(EventJournalTest, StopsAtSequenceGap) {
+    {
+        EventJournal journal;
+        ASSERT_TRUE(journal.open(path));
+        for (int id = 1; id <= 10; ++id) {
+            journal.set_input_position(id);
+            journal.log_cancel(id);
+        }
+        journal.close();
+    }
+
+    // Drop record 5; every remaining record still has a valid checksum
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        bytes = ss.str();
+    }
+    ASSERT_EQ(bytes.size(), 8 + 10 * sizeof(JournalRecord));
+    bytes.erase(8 + 5 * sizeof(JournalRecord), sizeof(JournalRecord));
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), bytes.size());
+    }
+
+    std::vector<JournalRecord> records;
+    ASSERT_TRUE(EventJournal::read_records(path, records));
+    ASSERT_EQ(records.size(), 5u);
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].sequence, i);
+        EXPECT_EQ(records[i].input_position, i + 1);
+    }
+
+    // Reopening returns the intact prefix and continues its numbering
+    EventJournal journal;
+    std::vector<JournalRecord> recovered;
+    ASSERT_TRUE(journal.open(path, &recovered));
+    EXPECT_EQ(recovered.size(), 5u);
+    journal.log_cancel(99);
+    journal.close();
+
+    records.clear();
+    ASSERT_TRUE(EventJournal::read_records(path, records));
+    ASSERT_EQ(records.size(), 6u);
+    EXPECT_EQ(records.back().order_id, 99);
+    EXPECT_EQ(records.back().sequence, 5u);
+}
+
+TEST_F(EventJournalTest, LoggingWhileClosedDoesNotBlock) {
+    OrderBook book;
+    EventJournal journal(std::chrono::microseconds(100), 4);
+    book.set_journal(&journal);
+
+    // Never opened: far more records than the ring holds
+    for (int i = 1; i <= 100; ++i) {
+        EXPECT_TRUE(book.add_order(Order(i, 100.0, 1, true, std::chrono::nanoseconds(0))));
+    }
+    EXPECT_TRUE(journal.has_failed());
+    EXPECT_EQ(journal.get_logged_count(), 0u);
+
+    // Closed after use
+    ASSERT_TRUE(journal.open(path));
+    EXPECT_FALSE(journal.has_failed());
+    EXPECT_TRUE(book.cancel_order(1));
+    journal.close();
+    for (int i = 101; i <= 200; ++i) {
+        EXPECT_TRUE(book.add_order(Order(i, 100.0, 1, true, std::chrono::nanoseconds(0))));
+    }
+    EXPECT_TRUE(journal.has_failed());
+    book.set_journal(nullptr);
+
+    std::vector<JournalRecord> records;
+    ASSERT_TRUE(EventJournal::read_records(path, records));
+    EXPECT_EQ(records.size(), 1u);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();